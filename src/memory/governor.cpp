@@ -0,0 +1,204 @@
+#include "governor.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace memory {
+
+namespace {
+
+// The size of every block is stored in front of it so that deallocation can
+// be accounted. The offset keeps the returned pointer aligned
+constexpr std::size_t default_alignment = alignof(std::max_align_t);
+
+// Extra memory granted while printing the report after the limit was hit
+constexpr std::size_t report_headroom = 1u << 20;
+
+struct PhaseStats {
+  std::atomic<std::size_t> allocated{0};
+  std::atomic<std::size_t> peak{0};
+};
+
+const char *const phase_names[NUM_PHASES] = {"startup", "parsing", "checking",
+                                             "analysis"};
+
+std::atomic<std::size_t> limit{0};
+std::atomic<std::size_t> usage{0};
+std::atomic<bool> exceeded{false};
+std::atomic<bool> reporting{false};
+std::atomic<Phase> current_phase{STARTUP};
+std::atomic<Phase> exceeded_phase{STARTUP};
+PhaseStats stats[NUM_PHASES];
+
+void *allocate(std::size_t size, std::size_t alignment) {
+  if (alignment < default_alignment) {
+    alignment = default_alignment;
+  }
+  if (size > SIZE_MAX - 2 * alignment) {
+    throw std::bad_alloc{};
+  }
+  auto new_usage = usage.fetch_add(size) + size;
+  auto max = limit.load();
+  if (max > 0 && reporting) {
+    max += report_headroom;
+  }
+  if (max > 0 && new_usage > max) {
+    usage.fetch_sub(size);
+    exceeded_phase = current_phase.load();
+    exceeded = true;
+    throw std::bad_alloc{};
+  }
+  // aligned_alloc requires the size to be a multiple of the alignment
+  auto block_size = (size + alignment + alignment - 1) & ~(alignment - 1);
+  char *block;
+  while (!(block = static_cast<char *>(
+               std::aligned_alloc(alignment, block_size)))) {
+    auto handler = std::get_new_handler();
+    if (!handler) {
+      usage.fetch_sub(size);
+      throw std::bad_alloc{};
+    }
+    try {
+      handler();
+    } catch (...) {
+      usage.fetch_sub(size);
+      throw;
+    }
+  }
+  std::memcpy(block, &size, sizeof(size));
+  auto &phase_stats = stats[current_phase.load()];
+  phase_stats.allocated += size;
+  auto peak = phase_stats.peak.load();
+  while (new_usage > peak &&
+         !phase_stats.peak.compare_exchange_weak(peak, new_usage)) {
+  }
+  return block + alignment;
+}
+
+void deallocate(void *ptr, std::size_t alignment) noexcept {
+  if (!ptr) {
+    return;
+  }
+  if (alignment < default_alignment) {
+    alignment = default_alignment;
+  }
+  auto *block = static_cast<char *>(ptr) - alignment;
+  std::size_t size;
+  std::memcpy(&size, block, sizeof(size));
+  usage.fetch_sub(size);
+  std::free(block);
+}
+
+} // namespace
+
+void set_limit(std::size_t bytes) { limit = bytes; }
+
+void set_phase(Phase phase) { current_phase = phase; }
+
+void print_report(std::ostream &out) {
+  reporting = true;
+  out << "Memory report";
+  if (limit > 0) {
+    out << " (limit " << limit << " bytes";
+    if (exceeded) {
+      out << ", exceeded during " << phase_names[exceeded_phase.load()];
+    }
+    out << ")";
+  }
+  out << ":\n";
+  for (unsigned int i = 0; i < NUM_PHASES; ++i) {
+    out << "  " << phase_names[i] << ": allocated " << stats[i].allocated
+        << " bytes, peak usage " << stats[i].peak << " bytes\n";
+  }
+  reporting = false;
+}
+
+} // namespace memory
+
+void *operator new(std::size_t size) {
+  return memory::allocate(size, memory::default_alignment);
+}
+
+void *operator new[](std::size_t size) {
+  return memory::allocate(size, memory::default_alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return memory::allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return memory::allocate(size, static_cast<std::size_t>(alignment));
+}
+
+// The nothrow forms must allocate through the governor as well, since every
+// form of operator delete expects the size header
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return memory::allocate(size, memory::default_alignment);
+  } catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return memory::allocate(size, memory::default_alignment);
+  } catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+  try {
+    return memory::allocate(size, static_cast<std::size_t>(alignment));
+  } catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  try {
+    return memory::allocate(size, static_cast<std::size_t>(alignment));
+  } catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+}
+
+void operator delete(void *ptr) noexcept {
+  memory::deallocate(ptr, memory::default_alignment);
+}
+
+void operator delete[](void *ptr) noexcept {
+  memory::deallocate(ptr, memory::default_alignment);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  memory::deallocate(ptr, memory::default_alignment);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+  memory::deallocate(ptr, memory::default_alignment);
+}
+
+void operator delete(void *ptr, std::align_val_t alignment) noexcept {
+  memory::deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *ptr, std::align_val_t alignment) noexcept {
+  memory::deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr, std::size_t,
+                     std::align_val_t alignment) noexcept {
+  memory::deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *ptr, std::size_t,
+                       std::align_val_t alignment) noexcept {
+  memory::deallocate(ptr, static_cast<std::size_t>(alignment));
+}
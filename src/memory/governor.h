@@ -0,0 +1,21 @@
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include <cstddef>
+#include <ostream>
+
+namespace memory {
+
+enum Phase : unsigned int { STARTUP, PARSING, CHECKING, ANALYSIS, NUM_PHASES };
+
+/* All allocations through the global operator new are accounted to the phase
+ * that is active when they happen. If a limit is set, every allocation that
+ * would exceed it throws std::bad_alloc. print_report gets a small fixed
+ * headroom above the limit so that the failure can still be reported */
+void set_limit(std::size_t bytes);
+void set_phase(Phase phase);
+void print_report(std::ostream &out);
+
+} // namespace memory
+
+#endif /* end of include guard: GOVERNOR_H */
@@ -0,0 +1,197 @@
+#ifndef GOAL_DECOMPOSITION_H
+#define GOAL_DECOMPOSITION_H
+
+#include "ast.h"
+#include "visitor.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+namespace model {
+
+using namespace parser::ast;
+
+/* Splits a conjunctive goal into groups of conjuncts that can be achieved
+ * independently of each other. Two fluent predicates interact if some action
+ * schema mentions both of them, static predicates never connect anything. Goal
+ * conjuncts whose predicates lie in different interaction components cannot
+ * interfere. Their subproblems can be solved separately and the plans
+ * concatenated, as long as each subproblem only uses the actions of its own
+ * component. Any other action may change the state of another component */
+class GoalDecomposition {
+public:
+  explicit GoalDecomposition(const AST &ast) {
+    if (!ast.get_domain() || !ast.get_problem()) {
+      return;
+    }
+    std::vector<const ActionDef *> action_defs;
+    std::vector<std::unordered_set<std::string>> actions;
+    std::unordered_set<std::string> fluents;
+    for (const auto &element : *ast.get_domain()->domain_body) {
+      const auto *action_def = std::get_if<ActionDef>(element.get());
+      if (!action_def) {
+        continue;
+      }
+      std::unordered_set<std::string> predicates;
+      if (action_def->precondition) {
+        auto precondition_predicates =
+            get_predicates_(*action_def->precondition.value()->precondition);
+        predicates.insert(precondition_predicates.begin(),
+                          precondition_predicates.end());
+      }
+      if (action_def->effect) {
+        auto effect_predicates =
+            get_predicates_(*action_def->effect.value()->effect);
+        fluents.insert(effect_predicates.begin(), effect_predicates.end());
+        predicates.insert(effect_predicates.begin(), effect_predicates.end());
+      }
+      action_defs.push_back(action_def);
+      actions.push_back(std::move(predicates));
+    }
+
+    for (const auto &predicates : actions) {
+      unite_fluents_(predicates, fluents);
+    }
+
+    std::vector<const Condition *> conjuncts;
+    for (const auto &element : *ast.get_problem()->problem_body) {
+      if (const auto *goal_def = std::get_if<GoalDef>(element.get())) {
+        add_conjuncts_(*goal_def->goal, conjuncts);
+      }
+    }
+
+    std::vector<std::unordered_set<std::string>> goal_predicates;
+    for (const auto *conjunct : conjuncts) {
+      auto predicates = get_predicates_(*conjunct);
+      unite_fluents_(predicates, fluents);
+      goal_predicates.push_back(std::move(predicates));
+    }
+
+    std::unordered_map<std::size_t, std::size_t> component_of_root;
+    for (std::size_t i = 0; i < conjuncts.size(); ++i) {
+      const std::string *fluent = nullptr;
+      for (const auto &predicate : goal_predicates[i]) {
+        if (fluents.count(predicate) > 0) {
+          fluent = &predicate;
+          break;
+        }
+      }
+      if (!fluent) {
+        // Static conjuncts do not depend on any action
+        components_.push_back({conjuncts[i]});
+        continue;
+      }
+      auto root = find_(get_index_(*fluent));
+      auto [it, inserted] =
+          component_of_root.try_emplace(root, components_.size());
+      if (inserted) {
+        components_.emplace_back();
+      }
+      components_[it->second].push_back(conjuncts[i]);
+    }
+
+    actions_.resize(components_.size());
+    for (std::size_t i = 0; i < action_defs.size(); ++i) {
+      for (const auto &predicate : actions[i]) {
+        if (fluents.count(predicate) == 0) {
+          continue;
+        }
+        // All fluents of an action lie in the same component
+        auto it = component_of_root.find(find_(get_index_(predicate)));
+        if (it != component_of_root.end()) {
+          actions_[it->second].push_back(action_defs[i]);
+        }
+        break;
+      }
+    }
+  }
+
+  const std::vector<std::vector<const Condition *>> &get_components() const {
+    return components_;
+  }
+
+  // The actions each component may use, in the same order as the components
+  const std::vector<std::vector<const ActionDef *>> &get_actions() const {
+    return actions_;
+  }
+
+private:
+  struct PredicateCollector
+      : public parser::visitor::Visitor<PredicateCollector> {
+    using Visitor<PredicateCollector>::traverse;
+    using Visitor<PredicateCollector>::visit_begin;
+    using Visitor<PredicateCollector>::visit_end;
+
+    bool visit_begin(const PredicateEvaluation &predicate_evaluation) {
+      if (predicate_evaluation.name->name != "=") {
+        predicates.insert(predicate_evaluation.name->name);
+      }
+      return true;
+    }
+
+    std::unordered_set<std::string> predicates;
+  };
+
+  // Nested conjunctions are flattened into their conjuncts
+  static void add_conjuncts_(const Condition &condition,
+                             std::vector<const Condition *> &conjuncts) {
+    if (const auto *conjunction = std::get_if<Conjunction>(&condition)) {
+      for (const auto &nested : *conjunction->conditions->elements) {
+        add_conjuncts_(*nested, conjuncts);
+      }
+    } else {
+      conjuncts.push_back(&condition);
+    }
+  }
+
+  static std::unordered_set<std::string>
+  get_predicates_(const Condition &condition) {
+    PredicateCollector collector;
+    collector.traverse(condition);
+    return std::move(collector.predicates);
+  }
+
+  void unite_fluents_(const std::unordered_set<std::string> &predicates,
+                      const std::unordered_set<std::string> &fluents) {
+    const std::string *first = nullptr;
+    for (const auto &predicate : predicates) {
+      if (fluents.count(predicate) == 0) {
+        continue;
+      }
+      if (!first) {
+        first = &predicate;
+        continue;
+      }
+      auto root = find_(get_index_(predicate));
+      parent_[root] = find_(get_index_(*first));
+    }
+  }
+
+  std::size_t get_index_(const std::string &predicate) {
+    auto [it, inserted] = indices_.try_emplace(predicate, parent_.size());
+    if (inserted) {
+      parent_.push_back(it->second);
+    }
+    return it->second;
+  }
+
+  std::size_t find_(std::size_t index) {
+    while (parent_[index] != index) {
+      parent_[index] = parent_[parent_[index]];
+      index = parent_[index];
+    }
+    return index;
+  }
+
+  std::unordered_map<std::string, std::size_t> indices_;
+  std::vector<std::size_t> parent_;
+  std::vector<std::vector<const Condition *>> components_;
+  std::vector<std::vector<const ActionDef *>> actions_;
+};
+
+} // namespace model
+
+#endif /* end of include guard: GOAL_DECOMPOSITION_H */
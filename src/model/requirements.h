@@ -0,0 +1,77 @@
+#ifndef REQUIREMENTS_H
+#define REQUIREMENTS_H
+
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace model {
+
+// Supported requirements as bit flags, plain STRIPS is the empty set
+enum Feature : unsigned int {
+  STRIPS = 0,
+  TYPING = 1u << 0,
+  NEGATIVE_PRECONDITIONS = 1u << 1,
+  DISJUNCTIVE_PRECONDITIONS = 1u << 2,
+  EQUALITY = 1u << 3,
+  ALL_FEATURES = (1u << 4) - 1
+};
+
+/* The set of requirements a problem uses, known at compile time. Later stages
+ * are templated on it so that handling of unused features can be removed
+ * with if constexpr */
+template <unsigned int Features> struct Requirements {
+  static constexpr unsigned int features = Features;
+  static constexpr bool typing = Features & TYPING;
+  static constexpr bool negative_preconditions =
+      Features & NEGATIVE_PRECONDITIONS;
+  static constexpr bool disjunctive_preconditions =
+      Features & DISJUNCTIVE_PRECONDITIONS;
+  static constexpr bool equality = Features & EQUALITY;
+};
+
+inline std::optional<unsigned int> get_feature(const std::string &name) {
+  if (name == ":strips") {
+    return STRIPS;
+  } else if (name == ":typing") {
+    return TYPING;
+  } else if (name == ":negative-preconditions") {
+    return NEGATIVE_PRECONDITIONS;
+  } else if (name == ":disjunctive-preconditions") {
+    return DISJUNCTIVE_PRECONDITIONS;
+  } else if (name == ":equality") {
+    return EQUALITY;
+  } else if (name == ":adl") {
+    return TYPING | NEGATIVE_PRECONDITIONS | DISJUNCTIVE_PRECONDITIONS |
+           EQUALITY;
+  }
+  return std::nullopt;
+}
+
+namespace detail {
+
+template <typename Function, unsigned int... Features>
+decltype(auto)
+dispatch_(unsigned int features, Function &&function,
+          std::integer_sequence<unsigned int, Features...>) {
+  using Result = decltype(function(Requirements<STRIPS>{}));
+  Result (*const instances[])(Function &) = {
+      [](Function &f) -> Result { return f(Requirements<Features>{}); }...};
+  return instances[features & ALL_FEATURES](function);
+}
+
+} // namespace detail
+
+/* Calls function with the Requirements instantiation matching the runtime
+ * feature set. All instantiations are generated, so function has to compile
+ * for every combination of features */
+template <typename Function>
+decltype(auto) dispatch(unsigned int features, Function &&function) {
+  return detail::dispatch_(
+      features, std::forward<Function>(function),
+      std::make_integer_sequence<unsigned int, ALL_FEATURES + 1>{});
+}
+
+} // namespace model
+
+#endif /* end of include guard: REQUIREMENTS_H */
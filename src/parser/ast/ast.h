@@ -109,10 +109,10 @@ struct TypesDef : Node {
 
 struct ConstantsDef : Node {
   ConstantsDef(const location &loc,
-               std::unique_ptr<TypedVariableList> constant_list)
+               std::unique_ptr<TypedNameList> constant_list)
       : Node{loc}, constant_list{std::move(constant_list)} {}
 
-  std::unique_ptr<TypedVariableList> constant_list;
+  std::unique_ptr<TypedNameList> constant_list;
 };
 
 struct Predicate : Node {
@@ -277,7 +277,8 @@ public:
   AST(const AST &) = delete;
   AST(AST &&other)
       : domain_file_{other.domain_file_},
-        problem_file_{other.problem_file_}, domain_{std::move(other.domain_)} {
+        problem_file_{other.problem_file_}, domain_{std::move(other.domain_)},
+        problem_{std::move(other.problem_)} {
     other.domain_file_ = "";
     other.problem_file_ = "";
   }
@@ -0,0 +1,142 @@
+#ifndef HASH_CONS_H
+#define HASH_CONS_H
+
+#include "ast.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace parser {
+
+namespace hash_cons {
+
+using namespace ast;
+
+using Id = std::size_t;
+
+namespace detail {
+
+struct KeyHash {
+  std::size_t operator()(const std::vector<Id> &key) const {
+    std::size_t seed = key.size();
+    for (auto value : key) {
+      seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+  }
+};
+
+// Maps structural keys to stable ids and remembers the first node seen for
+// each id as its canonical representative
+template <typename Node> class Table {
+public:
+  Id insert(std::vector<Id> key, const Node &node) {
+    auto [it, inserted] = ids_.try_emplace(std::move(key), nodes_.size());
+    if (inserted) {
+      nodes_.push_back(&node);
+    }
+    return it->second;
+  }
+
+  const Node &get(Id id) const { return *nodes_[id]; }
+  std::size_t size() const { return nodes_.size(); }
+
+private:
+  std::unordered_map<std::vector<Id>, Id, KeyHash> ids_;
+  std::vector<const Node *> nodes_;
+};
+
+} // namespace detail
+
+/* Structural sharing for conditions and argument lists. Identical subtrees are
+ * mapped to the same stable id regardless of their location, so later stages
+ * can process each distinct subformula once and cache the result in a vector
+ * indexed by that id. The AST itself is not modified, the canonical node for an
+ * id is the first one inserted and is only valid as long as the AST lives */
+class HashCons {
+public:
+  Id insert(const Argument &argument) {
+    std::vector<Id> key{argument.index()};
+    std::visit([this, &key](const auto &a) { add_children_(a, key); },
+               argument);
+    return arguments_.insert(std::move(key), argument);
+  }
+
+  Id insert(const ArgumentList &argument_list) {
+    std::vector<Id> key;
+    key.reserve(argument_list.elements->size());
+    for (const auto &argument : *argument_list.elements) {
+      key.push_back(insert(*argument));
+    }
+    return argument_lists_.insert(std::move(key), argument_list);
+  }
+
+  Id insert(const Condition &condition) {
+    std::vector<Id> key{condition.index()};
+    std::visit([this, &key](const auto &c) { add_children_(c, key); },
+               condition);
+    return conditions_.insert(std::move(key), condition);
+  }
+
+  const Argument &get_argument(Id id) const { return arguments_.get(id); }
+  const ArgumentList &get_argument_list(Id id) const {
+    return argument_lists_.get(id);
+  }
+  const Condition &get_condition(Id id) const { return conditions_.get(id); }
+
+  std::size_t num_arguments() const { return arguments_.size(); }
+  std::size_t num_argument_lists() const { return argument_lists_.size(); }
+  std::size_t num_conditions() const { return conditions_.size(); }
+
+private:
+  Id get_symbol_(const std::string &name) {
+    return symbols_.try_emplace(name, symbols_.size()).first->second;
+  }
+
+  void add_children_(const Name &name, std::vector<Id> &key) {
+    key.push_back(get_symbol_(name.name));
+  }
+
+  void add_children_(const Variable &variable, std::vector<Id> &key) {
+    key.push_back(get_symbol_(variable.variable));
+  }
+
+  void add_children_(const std::monostate &, std::vector<Id> &) {}
+
+  void add_children_(const PredicateEvaluation &predicate_evaluation,
+                     std::vector<Id> &key) {
+    key.push_back(get_symbol_(predicate_evaluation.name->name));
+    key.push_back(insert(*predicate_evaluation.arguments));
+  }
+
+  void add_children_(const Conjunction &conjunction, std::vector<Id> &key) {
+    add_children_(*conjunction.conditions, key);
+  }
+
+  void add_children_(const Disjunction &disjunction, std::vector<Id> &key) {
+    add_children_(*disjunction.conditions, key);
+  }
+
+  void add_children_(const Negation &negation, std::vector<Id> &key) {
+    key.push_back(insert(*negation.condition));
+  }
+
+  void add_children_(const ConditionList &condition_list,
+                     std::vector<Id> &key) {
+    for (const auto &condition : *condition_list.elements) {
+      key.push_back(insert(*condition));
+    }
+  }
+
+  std::unordered_map<std::string, Id> symbols_;
+  detail::Table<Argument> arguments_;
+  detail::Table<ArgumentList> argument_lists_;
+  detail::Table<Condition> conditions_;
+};
+
+} // namespace hash_cons
+} // namespace parser
+
+#endif /* end of include guard: HASH_CONS_H */
@@ -22,10 +22,10 @@ public:
 
   bool traverse(const AST &ast) {
     get_derived_().visit_begin(ast);
-    if (!ast.get_domain()) {
-      return get_derived_().visit_end(ast);
-    }
-    return get_derived_().traverse(*ast.get_domain()) &&
+    return (ast.get_domain() ? get_derived_().traverse(*ast.get_domain())
+                             : true) &&
+           (ast.get_problem() ? get_derived_().traverse(*ast.get_problem())
+                              : true) &&
            get_derived_().visit_end(ast);
   }
 
@@ -35,6 +35,14 @@ public:
     traverse_(*domain.domain_body) && get_derived_().visit_end(domain);
   }
 
+  bool traverse(const Problem &problem) {
+    return get_derived_().visit_begin(problem) &&
+           get_derived_().traverse(*problem.name) &&
+           get_derived_().traverse(*problem.domain_ref) &&
+           traverse_(*problem.problem_body) &&
+           get_derived_().visit_end(problem);
+  }
+
   bool traverse(const Element &element) {
     return get_derived_().visit_begin(element) &&
            std::visit(variant_visitor_, element) && visit_end(element);
@@ -77,6 +85,43 @@ public:
            get_derived_().visit_end(action_def);
   }
 
+  bool traverse(const ObjectsDef &objects_def) {
+    return get_derived_().visit_begin(objects_def) &&
+           get_derived_().traverse(*objects_def.objects) &&
+           get_derived_().visit_end(objects_def);
+  }
+
+  bool traverse(const InitDef &init_def) {
+    return get_derived_().visit_begin(init_def) &&
+           get_derived_().traverse(*init_def.init_predicates) &&
+           get_derived_().visit_end(init_def);
+  }
+
+  bool traverse(const GoalDef &goal_def) {
+    return get_derived_().visit_begin(goal_def) &&
+           get_derived_().traverse(*goal_def.goal) &&
+           get_derived_().visit_end(goal_def);
+  }
+
+  bool traverse(const InitCondition &init_condition) {
+    return get_derived_().visit_begin(init_condition) &&
+           std::visit(variant_visitor_, init_condition) &&
+           get_derived_().visit_end(init_condition);
+  }
+
+  bool traverse(const InitPredicate &init_predicate) {
+    return get_derived_().visit_begin(init_predicate) &&
+           get_derived_().traverse(*init_predicate.name) &&
+           get_derived_().traverse(*init_predicate.arguments) &&
+           get_derived_().visit_end(init_predicate);
+  }
+
+  bool traverse(const InitNegation &init_negation) {
+    return get_derived_().visit_begin(init_negation) &&
+           get_derived_().traverse(*init_negation.init_predicate) &&
+           get_derived_().visit_end(init_negation);
+  }
+
   bool traverse(const Precondition &precondition) {
     return get_derived_().visit_begin(precondition) &&
            get_derived_().traverse(*precondition.precondition) &&
@@ -162,7 +162,7 @@ types-def:
 ;
 constants-def:
     "(" CONSTANTS typed-name-list[constants-list] ")" {
-      $$ = std::make_unique<ast::Element>(ast::TypesDef{@$, std::move($[constants-list])});
+      $$ = std::make_unique<ast::Element>(ast::ConstantsDef{@$, std::move($[constants-list])});
     }
 ;
 predicates-def:
@@ -1,9 +1,15 @@
 #include "config.h"
 #include "driver.h"
+#include "goal_decomposition.h"
+#include "governor.h"
 #include "parser.hxx"
+#include "requirements.h"
 #include "scanner.h"
 #include "visitor.h"
+#include <cctype>
+#include <cstdint>
 #include <iostream>
+#include <new>
 
 using namespace parser::ast;
 
@@ -123,6 +129,126 @@ public:
   }
 };
 
+class RequirementsCollector
+    : public parser::visitor::Visitor<RequirementsCollector> {
+public:
+  using Visitor<RequirementsCollector>::traverse;
+  using Visitor<RequirementsCollector>::visit_begin;
+  using Visitor<RequirementsCollector>::visit_end;
+
+  bool visit_begin(const Requirement &a) {
+    auto feature = model::get_feature(a.name);
+    if (!feature) {
+      // The grammar cannot express anything that depends on it
+      std::cerr << a.loc << ": warning, ignoring unsupported requirement "
+                << a.name << '\n';
+      return true;
+    }
+    features |= *feature;
+    return true;
+  }
+
+  unsigned int features = model::STRIPS;
+};
+
+// Rejects features that are used but not declared in the requirements
+template <typename Requirements>
+class RequirementsChecker
+    : public parser::visitor::Visitor<RequirementsChecker<Requirements>> {
+  using Base = parser::visitor::Visitor<RequirementsChecker<Requirements>>;
+
+public:
+  using Base::traverse;
+  using Base::visit_begin;
+  using Base::visit_end;
+
+  bool visit_begin(const Effect &) {
+    in_effect_ = true;
+    return true;
+  }
+  bool visit_end(const Effect &) {
+    in_effect_ = false;
+    return true;
+  }
+  bool visit_begin([[maybe_unused]] const Negation &a) {
+    if constexpr (!Requirements::negative_preconditions) {
+      // Negations in effects are delete effects
+      if (!in_effect_) {
+        return error_(a.loc, ":negative-preconditions");
+      }
+    }
+    return true;
+  }
+  bool visit_begin([[maybe_unused]] const Disjunction &a) {
+    if constexpr (!Requirements::disjunctive_preconditions) {
+      return error_(a.loc, ":disjunctive-preconditions");
+    }
+    return true;
+  }
+  bool visit_begin([[maybe_unused]] const PredicateEvaluation &a) {
+    if constexpr (!Requirements::equality) {
+      if (a.name->name == "=") {
+        return error_(a.loc, ":equality");
+      }
+    }
+    return true;
+  }
+  bool visit_begin([[maybe_unused]] const TypesDef &a) {
+    if constexpr (!Requirements::typing) {
+      return error_(a.loc, ":typing");
+    }
+    return true;
+  }
+  bool visit_begin([[maybe_unused]] const SingleTypedNameList &a) {
+    if constexpr (!Requirements::typing) {
+      if (a.type) {
+        return error_(a.loc, ":typing");
+      }
+    }
+    return true;
+  }
+  bool visit_begin([[maybe_unused]] const SingleTypedVariableList &a) {
+    if constexpr (!Requirements::typing) {
+      if (a.type) {
+        return error_(a.loc, ":typing");
+      }
+    }
+    return true;
+  }
+
+private:
+  bool error_(const parser::location &loc, const std::string &requirement) {
+    std::cerr << loc << ": semantic error, requirement " << requirement
+              << " not declared" << '\n';
+    return false;
+  }
+
+  bool in_effect_ = false;
+};
+
+template <typename Requirements> int run(const AST &ast) {
+  RequirementsChecker<Requirements> checker;
+  if (!checker.traverse(ast)) {
+    return 1;
+  }
+  std::cout << "Test" << std::endl;
+  MyVisitor v;
+  v.traverse(ast);
+  memory::set_phase(memory::ANALYSIS);
+  model::GoalDecomposition goal_decomposition{ast};
+  const auto &components = goal_decomposition.get_components();
+  const auto &actions = goal_decomposition.get_actions();
+  std::cout << "Goal components: " << components.size() << '\n';
+  for (std::size_t i = 0; i < components.size(); ++i) {
+    std::cout << "  " << components[i].size() << " goal(s), actions:";
+    for (const auto *action_def : actions[i]) {
+      std::cout << ' ' << action_def->name->name;
+    }
+    std::cout << '\n';
+  }
+  return 0;
+}
+
 int main(int argc, char *argv[]) {
   /* std::cout << "This is rantanplan version " << VERSION_MAJOR << "." */
   /*           << VERSION_MINOR << '\n'; */
@@ -134,13 +260,51 @@ int main(int argc, char *argv[]) {
   std::string domain_in{argv[1]};
   std::string problem_in{argv[2]};
 
-  auto ast = parser::parse(&domain_in, &problem_in);
+  for (int i = 3; i < argc; ++i) {
+    std::string option{argv[i]};
+    const std::string memory_limit{"--memory-limit="};
+    if (option.compare(0, memory_limit.size(), memory_limit) == 0) {
+      // The limit is given in MiB and has to be positive
+      auto value = option.substr(memory_limit.size());
+      std::size_t end = 0;
+      unsigned long long mib = 0;
+      if (!value.empty() &&
+          std::isdigit(static_cast<unsigned char>(value[0]))) {
+        try {
+          mib = std::stoull(value, &end);
+        } catch (const std::out_of_range &) {
+          end = 0;
+        }
+      }
+      if (end == 0 || end != value.size() || mib == 0 ||
+          mib > (SIZE_MAX >> 20)) {
+        std::cerr << "Invalid memory limit: " << option << '\n';
+        return 1;
+      }
+      memory::set_limit(static_cast<std::size_t>(mib) << 20);
+    } else {
+      std::cerr << "Unknown option: " << option << '\n';
+      return 1;
+    }
+  }
+
+  try {
+    memory::set_phase(memory::PARSING);
+    auto ast = parser::parse(&domain_in, &problem_in);
 
-  if (ast) {
-    std::cout << "Test" << std::endl;
-    MyVisitor v;
-    v.traverse(*ast);
-    return 0;
+    if (ast) {
+      memory::set_phase(memory::CHECKING);
+      RequirementsCollector collector;
+      if (!collector.traverse(*ast)) {
+        return 1;
+      }
+      return model::dispatch(collector.features, [&ast](auto requirements) {
+        return run<decltype(requirements)>(*ast);
+      });
+    }
+  } catch (const std::bad_alloc &) {
+    std::cerr << "Out of memory" << '\n';
+    memory::print_report(std::cerr);
   }
   return 1;
 }